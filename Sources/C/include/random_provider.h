@@ -32,6 +32,24 @@
 //------------------------------------------------------- initializer
 void seed_random(unsigned int seed);
 
+//-------------------------------------------- bulk kernel variants
+//The deterministic bulk loops (set_all_bits_high/low, the clamp step
+//of fuzz_buffer) are compiled once per instruction set. The best one
+//the CPU supports is picked on first use. Anything that calls rand()
+//per element stays scalar so seeded sequences don't change.
+typedef enum {
+    BULK_KERNEL_SCALAR = 0,
+    BULK_KERNEL_SSE2 = 1,
+    BULK_KERNEL_AVX2 = 2,
+    BULK_KERNEL_AVX512 = 3
+} bulk_kernel_level;
+
+bulk_kernel_level bulk_kernel_detected();
+bulk_kernel_level bulk_kernel_active();
+//returns 0 on success, -1 if this CPU can't run that level.
+int bulk_kernel_override(const bulk_kernel_level level);
+const char* bulk_kernel_name(const bulk_kernel_level level);
+
 //----------------------------------------------------- single values
 int random_int();
 void random_int_with_result_pointer(int* result);
@@ -58,6 +76,46 @@ int fuzz_buffer(int* settings,
                 void* output_buffer
                 );
 
+//------------------------------------------- fuzzing with cached noise
+//For video: instead of fresh rand() per byte, precompute a tileable
+//tile_size x tile_size pixel noise texture once per (seed, fuzz_amount,
+//tile_size, bytes_per_pixel, kind) and lay it over each frame at a random
+//(x, y) offset drawn from the caller's offset_state. The per-byte work
+//is just the saturating add/sub kernel.
+//Safe to call from several threads (tiles are reference counted) as long
+//as each thread passes its own offset_state.
+//Up to 8 tiles are cached. At the largest size (1024 px, 16 bytes per
+//pixel) that is 64 MB each, 512 MB total; noise_cache_clear() gives it back.
+typedef enum {
+    NOISE_UNIFORM = 0,   //same distribution as fuzz_buffer
+    NOISE_HIGH_PASS = 1  //each channel differenced with the same channel of the pixels left and above, "blue-ish"
+} noise_kind;
+
+//reentrant generator (xorshift32) so the tiles don't touch rand()'s state.
+//(header-only version in random_provider_inline.h)
+//state must not be 0.
+uint32_t random_step_r(uint32_t* state);
+
+//Buffers are width * height * bytes_per_pixel bytes, rows packed.
+//offset_state is the stream's own generator state (one per stream/thread),
+//stepped twice per frame with random_step_r. Start it at 0 to derive it from
+//seed; the same start gives the same offsets every run.
+//tile_size of 0 uses the default (64). Returns 0, or -1 if tile_size is over 1024,
+//bytes_per_pixel is 0 or over 16, offset_state is NULL, the frame size overflows,
+//or the tile could not be allocated.
+int fuzz_buffer_cached(const uint32_t seed,
+                       const uint8_t fuzz_amount,
+                       const size_t tile_size,
+                       const noise_kind kind,
+                       const size_t width,
+                       const size_t height,
+                       const size_t bytes_per_pixel,
+                       uint32_t* offset_state,
+                       const void* input_buffer,
+                       void* output_buffer
+                       );
+void noise_cache_clear();
+
 
 //------------------------------------------- retrieving fixed arrays
 uint8_t random_provider_uint8_array[27];
@@ -103,6 +161,7 @@ union CColorRGBA2 {
     struct c_color_comp components;
 };
 
+uint32_t build_color(uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha);
 void random_colors_full_alpha(uint32_t* array, const size_t n);
 uint32_t random_color_and_alpha();
 uint32_t random_color_full_alpha();
@@ -117,6 +176,13 @@ void answer_to_life(char* result);
 void build_concise_message(char* result, size_t* length);
 void random_scramble(const char* input, char* output, size_t* length);
 
+//bounded, non-printing versions. Write at most capacity bytes (NUL included)
+//and return the length needed without the NUL, like snprintf.
+void print_message_n(const char* message, const size_t length);
+size_t answer_to_life_n(char* result, const size_t capacity);
+size_t build_concise_message_n(char* result, const size_t capacity);
+size_t random_scramble_n(const char* input, const size_t input_length, char* output, const size_t capacity);
+
 
 //---------------------------------------------------- utility prints
 void acknowledge_buffer(int* array, const size_t n);
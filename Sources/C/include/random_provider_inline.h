@@ -0,0 +1,86 @@
+//
+//  random_provider_inline.h
+//
+//
+// Opt-in header-only versions of the tiny functions in random_provider.h.
+//
+// The out-of-line versions are opaque calls from Swift, so a loop over
+// ccolor_get_red can't be inlined or vectorized. Everything here is
+// `static inline`, which the ClangImporter CAN inline into Swift code.
+// None of them print (the int_from_* originals do).
+//
+// COpaqueColor stays an incomplete type (so it still comes into Swift as
+// an OpaquePointer). Instead of the struct, the byte offsets of its
+// members are published here. random_provider.c checks them against the
+// real struct at compile time.
+//
+#ifndef random_provider_inline_h
+#define random_provider_inline_h
+
+#include <stdint.h>
+#include "random_provider.h"
+
+//------------------------------------------------- COpaqueColor layout
+//same order as union CColorRGBA: #RRGGBBAA on a little endian machine.
+enum {
+    CCOLOR_ALPHA_OFFSET = 0,
+    CCOLOR_BLUE_OFFSET = 1,
+    CCOLOR_GREEN_OFFSET = 2,
+    CCOLOR_RED_OFFSET = 3,
+    CCOLOR_SIZE = 4
+};
+
+//----------------------------------------------------- getters/setters
+//Going through uint8_t* (a character type) keeps this legal to alias.
+static inline uint8_t ccolor_get_red_inline(const COpaqueColor* c) { return ((const uint8_t*)c)[CCOLOR_RED_OFFSET]; }
+static inline uint8_t ccolor_get_green_inline(const COpaqueColor* c) { return ((const uint8_t*)c)[CCOLOR_GREEN_OFFSET]; }
+static inline uint8_t ccolor_get_blue_inline(const COpaqueColor* c) { return ((const uint8_t*)c)[CCOLOR_BLUE_OFFSET]; }
+static inline uint8_t ccolor_get_alpha_inline(const COpaqueColor* c) { return ((const uint8_t*)c)[CCOLOR_ALPHA_OFFSET]; }
+
+static inline void set_color_values_inline(COpaqueColor* c, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha) {
+    uint8_t* bytes = (uint8_t*)c;
+    bytes[CCOLOR_RED_OFFSET] = red;
+    bytes[CCOLOR_GREEN_OFFSET] = green;
+    bytes[CCOLOR_BLUE_OFFSET] = blue;
+    bytes[CCOLOR_ALPHA_OFFSET] = alpha;
+}
+
+//------------------------------------------------------------ packers
+static inline uint32_t build_color_inline(uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha) {
+    return ((uint32_t)red << 24) | ((uint32_t)green << 16) | ((uint32_t)blue << 8) | alpha;
+}
+
+//int_from_copaque_color_ptr without the printf.
+static inline uint32_t int_from_copaque_color_ptr_inline(const COpaqueColor* color) {
+    return build_color_inline(ccolor_get_red_inline(color),
+                              ccolor_get_green_inline(color),
+                              ccolor_get_blue_inline(color),
+                              ccolor_get_alpha_inline(color));
+}
+
+//int_from_opaque_color without the printf. struct opaque_color has the same layout.
+static inline uint32_t int_from_opaque_color_inline(OpaqueColor color) {
+    return int_from_copaque_color_ptr_inline((const COpaqueColor*)color);
+}
+
+//------------------------------------------------- reentrant generator
+//Same xorshift32 step as random_step_r. state must not be 0.
+static inline uint32_t random_step_r_inline(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+//random_color_full_alpha, but from caller owned state instead of rand().
+static inline uint32_t random_color_full_alpha_r_inline(uint32_t* state) {
+    uint8_t blue = random_step_r_inline(state) % 255;
+    uint8_t green = random_step_r_inline(state) % 255;
+    uint8_t red = random_step_r_inline(state) % 255;
+    return build_color_inline(red, green, blue, 255);
+}
+
+//-------------------------------------------------------------------
+#endif /* random_provider_inline_h */
@@ -16,7 +16,12 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <pthread.h>
 #include "random_provider.h"
+#include "random_provider_inline.h"
 
 //-------------------------------------------------------------------
 //MARK: structs and unions for typedefs
@@ -38,6 +43,14 @@ struct COpaqueColor {
     uint8_t red;
 };
 
+//random_provider_inline.h publishes these offsets instead of the struct.
+_Static_assert(offsetof(struct COpaqueColor, alpha) == CCOLOR_ALPHA_OFFSET, "COpaqueColor layout changed");
+_Static_assert(offsetof(struct COpaqueColor, blue) == CCOLOR_BLUE_OFFSET, "COpaqueColor layout changed");
+_Static_assert(offsetof(struct COpaqueColor, green) == CCOLOR_GREEN_OFFSET, "COpaqueColor layout changed");
+_Static_assert(offsetof(struct COpaqueColor, red) == CCOLOR_RED_OFFSET, "COpaqueColor layout changed");
+_Static_assert(sizeof(struct COpaqueColor) == CCOLOR_SIZE, "COpaqueColor layout changed");
+_Static_assert(sizeof(struct opaque_color) == CCOLOR_SIZE, "opaque_color layout changed");
+
 //-------------------------------------------------------------------
 //MARK: Constants
 //-------------------------------------------------------------------
@@ -66,6 +79,181 @@ const unsigned char valid_alpha[52] = { 0b01000001, 0b01000010, 0b01000011, 0b01
     0b01101111, 0b01110000, 0b01110001, 0b01110010, 0b01110011, 0b01110100, 0b01110101,
     0b01110110, 0b01110111, 0b01111000, 0b01111001, 0b01111010 };
 
+//-------------------------------------------------------------------
+//MARK: Bulk Kernels (runtime dispatch)
+//-------------------------------------------------------------------
+
+// Each kernel is written once per instruction set and called through a
+// function pointer table. The table is picked the first time any bulk
+// function runs. ifunc would do this at load time, but it only exists
+// on ELF (not MacOS), so a lazily filled pointer it is.
+//
+// Only the x86 variants need a target attribute. Everywhere else the
+// scalar version is it (and the compiler already vectorizes it for
+// the baseline ISA, e.g. NEON on arm64).
+
+#if defined(__x86_64__) || defined(__i386__)
+#define RP_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+struct bulk_kernels {
+    bulk_kernel_level level;
+    void (*fill_bytes)(uint8_t* dst, const uint8_t value, const size_t n);
+    //out = clamp(in + up - down). Only one of up/down is non-zero per byte.
+    void (*apply_up_down)(const uint8_t* in, const uint8_t* up, const uint8_t* down, uint8_t* out, const size_t n);
+};
+
+static void fill_bytes_scalar(uint8_t* dst, const uint8_t value, const size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = value;
+    }
+}
+
+static void apply_up_down_scalar(const uint8_t* in, const uint8_t* up, const uint8_t* down, uint8_t* out, const size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        int16_t result = in[i] + up[i] - down[i];
+        if (result < 0) { result = 0; }
+        else if (result > 255) { result = 255; };
+        out[i] = (result & 0xff);
+    }
+}
+
+#ifdef RP_X86_KERNELS
+
+__attribute__((target("sse2")))
+static void fill_bytes_sse2(uint8_t* dst, const uint8_t value, const size_t n) {
+    const __m128i v = _mm_set1_epi8((char)value);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm_storeu_si128((__m128i*)(dst + i), v);
+    }
+    fill_bytes_scalar(dst + i, value, n - i);
+}
+
+__attribute__((target("sse2")))
+static void apply_up_down_sse2(const uint8_t* in, const uint8_t* up, const uint8_t* down, uint8_t* out, const size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+        v = _mm_adds_epu8(v, _mm_loadu_si128((const __m128i*)(up + i)));
+        v = _mm_subs_epu8(v, _mm_loadu_si128((const __m128i*)(down + i)));
+        _mm_storeu_si128((__m128i*)(out + i), v);
+    }
+    apply_up_down_scalar(in + i, up + i, down + i, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static void fill_bytes_avx2(uint8_t* dst, const uint8_t value, const size_t n) {
+    const __m256i v = _mm256_set1_epi8((char)value);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        _mm256_storeu_si256((__m256i*)(dst + i), v);
+    }
+    fill_bytes_scalar(dst + i, value, n - i);
+}
+
+__attribute__((target("avx2")))
+static void apply_up_down_avx2(const uint8_t* in, const uint8_t* up, const uint8_t* down, uint8_t* out, const size_t n) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(in + i));
+        v = _mm256_adds_epu8(v, _mm256_loadu_si256((const __m256i*)(up + i)));
+        v = _mm256_subs_epu8(v, _mm256_loadu_si256((const __m256i*)(down + i)));
+        _mm256_storeu_si256((__m256i*)(out + i), v);
+    }
+    apply_up_down_scalar(in + i, up + i, down + i, out + i, n - i);
+}
+
+//byte-wise saturating math on 512 bits needs BW, not just F.
+__attribute__((target("avx512f,avx512bw")))
+static void fill_bytes_avx512(uint8_t* dst, const uint8_t value, const size_t n) {
+    const __m512i v = _mm512_set1_epi8((char)value);
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        _mm512_storeu_si512((void*)(dst + i), v);
+    }
+    fill_bytes_scalar(dst + i, value, n - i);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void apply_up_down_avx512(const uint8_t* in, const uint8_t* up, const uint8_t* down, uint8_t* out, const size_t n) {
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m512i v = _mm512_loadu_si512((const void*)(in + i));
+        v = _mm512_adds_epu8(v, _mm512_loadu_si512((const void*)(up + i)));
+        v = _mm512_subs_epu8(v, _mm512_loadu_si512((const void*)(down + i)));
+        _mm512_storeu_si512((void*)(out + i), v);
+    }
+    apply_up_down_scalar(in + i, up + i, down + i, out + i, n - i);
+}
+
+#endif
+
+static const struct bulk_kernels bulk_kernel_table[4] = {
+    { BULK_KERNEL_SCALAR, fill_bytes_scalar, apply_up_down_scalar },
+#ifdef RP_X86_KERNELS
+    { BULK_KERNEL_SSE2, fill_bytes_sse2, apply_up_down_sse2 },
+    { BULK_KERNEL_AVX2, fill_bytes_avx2, apply_up_down_avx2 },
+    { BULK_KERNEL_AVX512, fill_bytes_avx512, apply_up_down_avx512 },
+#else
+    { BULK_KERNEL_SCALAR, fill_bytes_scalar, apply_up_down_scalar },
+    { BULK_KERNEL_SCALAR, fill_bytes_scalar, apply_up_down_scalar },
+    { BULK_KERNEL_SCALAR, fill_bytes_scalar, apply_up_down_scalar },
+#endif
+};
+
+//NULL until first use. Atomic because every bulk call reads it while the
+//lazy fill or bulk_kernel_override may be writing it from another thread.
+//The table entries are constant, so relaxed ordering is enough.
+static _Atomic(const struct bulk_kernels*) active_bulk_kernels = NULL;
+
+bulk_kernel_level bulk_kernel_detected() {
+#ifdef RP_X86_KERNELS
+    //__builtin_cpu_supports also checks that the OS saves the wider registers.
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) { return BULK_KERNEL_AVX512; }
+    if (__builtin_cpu_supports("avx2")) { return BULK_KERNEL_AVX2; }
+    if (__builtin_cpu_supports("sse2")) { return BULK_KERNEL_SSE2; }
+#endif
+    return BULK_KERNEL_SCALAR;
+}
+
+static const struct bulk_kernels* bulk_kernels() {
+    const struct bulk_kernels* kernels = atomic_load_explicit(&active_bulk_kernels, memory_order_relaxed);
+    if (kernels == NULL) {
+        //only fill if still empty, so a racing bulk_kernel_override isn't clobbered.
+        const struct bulk_kernels* detected = &bulk_kernel_table[bulk_kernel_detected()];
+        if (atomic_compare_exchange_strong_explicit(&active_bulk_kernels, &kernels, detected,
+                                                    memory_order_relaxed, memory_order_relaxed)) {
+            kernels = detected;
+        }
+    }
+    return kernels;
+}
+
+bulk_kernel_level bulk_kernel_active() {
+    return bulk_kernels()->level;
+}
+
+int bulk_kernel_override(const bulk_kernel_level level) {
+    if (level < BULK_KERNEL_SCALAR || level > bulk_kernel_detected()) {
+        return -1;
+    }
+    atomic_store_explicit(&active_bulk_kernels, &bulk_kernel_table[level], memory_order_relaxed);
+    return 0;
+}
+
+const char* bulk_kernel_name(const bulk_kernel_level level) {
+    switch (level) {
+        case BULK_KERNEL_SCALAR: return "scalar";
+        case BULK_KERNEL_SSE2: return "sse2";
+        case BULK_KERNEL_AVX2: return "avx2";
+        case BULK_KERNEL_AVX512: return "avx512";
+    }
+    return "unknown";
+}
+
 //-------------------------------------------------------------------
 //MARK:  Setup
 //-------------------------------------------------------------------
@@ -185,17 +373,33 @@ int fuzz_buffer(int* settings,
     for (int p = 0; p < *calculated_size_ptr; p++) {
         printf("i:%d, v:%02x\t", p, ((unsigned char*)input_buffer)[p]);
         if ((p+1) % ((*width_ptr * bytes_per_pixel)) == 0) { printf("\n"); }
-        //((char*)output_buffer)[p] = ((unsigned char*)input_buffer)[p] + 2;
-        //unsigned char test = 100;
-        //((unsigned char*)output_buffer)[p] = char_whiffle(&test, 5);
-        ((unsigned char*)output_buffer)[p] = char_whiffle(&((unsigned char*)input_buffer)[p], fuzz_amount);
-        
     }
+    
+    //Same math as char_whiffle, split in two: rand() (serial, has to stay
+    //scalar) fills up/down amounts a chunk at a time, then the dispatched
+    //kernel does the saturating add/sub.
+    //((unsigned char*)output_buffer)[p] = char_whiffle(&((unsigned char*)input_buffer)[p], fuzz_amount);
+    const unsigned char* in = input_buffer;
+    unsigned char* out = output_buffer;
+    uint8_t up[256];
+    uint8_t down[256];
+    for (size_t start = 0; start < *calculated_size_ptr; start += 256) {
+        size_t chunk = *calculated_size_ptr - start;
+        if (chunk > 256) { chunk = 256; }
+        for (size_t i = 0; i < chunk; i++) {
+            int16_t wiffle_amount = (fuzz_amount == 0) ? 0 : (rand() % (2 * fuzz_amount)) - fuzz_amount;
+            up[i] = (wiffle_amount > 0) ? wiffle_amount : 0;
+            down[i] = (wiffle_amount < 0) ? -wiffle_amount : 0;
+        }
+        bulk_kernels()->apply_up_down(in + start, up, down, out + start, chunk);
+    }
+    
     printf("\nOUTPUT\n");
     for (int p = 0; p < *calculated_size_ptr; p++) {
         printf("i:%d, v:%02x\t", p, ((unsigned char*)output_buffer)[p]);
         if ((p+1) % ((*width_ptr * bytes_per_pixel)) == 0) { printf("\n"); }
     }
+    return 0;
 }
 
 void call_buffer_process_test() {
@@ -222,6 +426,230 @@ void call_buffer_process_test() {
     free(output_buffer);
 }
 
+//-------------------------------------------------------------------
+//MARK: Fuzzing with a Noise Cache
+//-------------------------------------------------------------------
+
+#define NOISE_CACHE_COUNT 8
+#define NOISE_DEFAULT_TILE 64          //pixels per side
+#define NOISE_MAX_TILE 1024            //pixels per side
+#define NOISE_MAX_BYTES_PER_PIXEL 16
+#define NOISE_ALIGNMENT 64
+
+//Worst case memory: a 1024 px, 16 byte-per-pixel tile is 64 MB (two 32 MB
+//planes), so a full cache of those holds 8 x 64 MB = 512 MB. Building one
+//also needs a temporary 32 MB. Tiles evicted while in use stay alive until
+//their last user finishes, so that can briefly go higher. Typical video
+//(64 px, 4 bytes per pixel) is 64 KB per tile.
+
+//A tile_size x tile_size pixel texture, bytes_per_pixel channels each.
+//Every row is stored twice in a row (2 * row_bytes), so reading row_bytes
+//from any x offset into the first copy never has to wrap. Rows are padded
+//to row_stride to keep each one aligned.
+struct noise_tile {
+    uint32_t seed;
+    uint8_t fuzz_amount;
+    size_t tile_size;
+    size_t bytes_per_pixel;
+    noise_kind kind;
+    size_t row_bytes;   //tile_size * bytes_per_pixel
+    size_t row_stride;  //2 * row_bytes rounded up to NOISE_ALIGNMENT
+    uint8_t* up;
+    uint8_t* down;      //same allocation as up, freeing up frees both.
+    size_t refs;        //one for the cache slot, one per call using it. Guarded by noise_cache_lock.
+};
+
+//The lock covers the slots and every tile's refs. It is NOT held while a
+//frame is being fuzzed; the ref keeps an evicted tile alive until the last
+//user is done with it.
+static pthread_mutex_t noise_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct noise_tile* noise_cache[NOISE_CACHE_COUNT];
+static size_t noise_cache_next = 0; //round robin eviction
+
+uint32_t random_step_r(uint32_t* state) {
+    return random_step_r_inline(state);
+}
+
+static int16_t noise_uniform_r(uint32_t* state, const uint8_t fuzz_amount) {
+    if (fuzz_amount == 0) { return 0; }
+    return (int16_t)(random_step_r(state) % (2u * fuzz_amount)) - fuzz_amount;
+}
+
+static void release_noise_tile(struct noise_tile* tile) {
+    //call with noise_cache_lock held.
+    if (tile != NULL && --tile->refs == 0) {
+        free(tile->up);
+        free(tile);
+    }
+}
+
+static struct noise_tile* make_noise_tile(const uint32_t seed, const uint8_t fuzz_amount, const size_t tile_size, const size_t bytes_per_pixel, const noise_kind kind) {
+    //sizes are capped by the caller, none of this math can overflow.
+    struct noise_tile* tile = malloc(sizeof(struct noise_tile));
+    if (tile == NULL) { return NULL; }
+    tile->seed = seed;
+    tile->fuzz_amount = fuzz_amount;
+    tile->tile_size = tile_size;
+    tile->bytes_per_pixel = bytes_per_pixel;
+    tile->kind = kind;
+    tile->row_bytes = tile_size * bytes_per_pixel;
+    tile->row_stride = (2 * tile->row_bytes + NOISE_ALIGNMENT - 1) & ~((size_t)NOISE_ALIGNMENT - 1);
+    tile->refs = 1;
+
+    const size_t plane_bytes = tile_size * tile->row_stride;
+    void* block = NULL;
+    int16_t* white = malloc(tile_size * tile->row_bytes * sizeof(int16_t));
+    if (white == NULL || posix_memalign(&block, NOISE_ALIGNMENT, 2 * plane_bytes) != 0) {
+        free(white);
+        free(tile);
+        return NULL;
+    }
+    tile->up = block;
+    tile->down = tile->up + plane_bytes;
+
+    uint32_t state = (seed != 0) ? seed : 0x9E3779B9;
+    for (size_t i = 0; i < tile_size * tile->row_bytes; i++) {
+        white[i] = noise_uniform_r(&state, fuzz_amount);
+    }
+
+    for (size_t y = 0; y < tile_size; y++) {
+        uint8_t* up_row = tile->up + y * tile->row_stride;
+        uint8_t* down_row = tile->down + y * tile->row_stride;
+        for (size_t x = 0; x < tile_size; x++) {
+            for (size_t c = 0; c < bytes_per_pixel; c++) {
+                const size_t i = y * tile->row_bytes + x * bytes_per_pixel + c;
+                int16_t delta = white[i];
+                if (kind == NOISE_HIGH_PASS) {
+                    //same channel of the pixel to the left and the pixel above,
+                    //wrapping so the tile still tiles. Stays within ±fuzz_amount.
+                    const size_t left_x = (x + tile_size - 1) % tile_size;
+                    const size_t above_y = (y + tile_size - 1) % tile_size;
+                    const int16_t left = white[y * tile->row_bytes + left_x * bytes_per_pixel + c];
+                    const int16_t above = white[above_y * tile->row_bytes + x * bytes_per_pixel + c];
+                    delta = (2 * white[i] - left - above) / 4;
+                }
+                up_row[x * bytes_per_pixel + c] = (delta > 0) ? delta : 0;
+                down_row[x * bytes_per_pixel + c] = (delta < 0) ? -delta : 0;
+            }
+        }
+        memcpy(up_row + tile->row_bytes, up_row, tile->row_bytes);
+        memcpy(down_row + tile->row_bytes, down_row, tile->row_bytes);
+    }
+    free(white);
+    return tile;
+}
+
+//call with noise_cache_lock held.
+static struct noise_tile* find_noise_tile(const uint32_t seed, const uint8_t fuzz_amount, const size_t tile_size, const size_t bytes_per_pixel, const noise_kind kind) {
+    for (size_t i = 0; i < NOISE_CACHE_COUNT; i++) {
+        struct noise_tile* tile = noise_cache[i];
+        if (tile != NULL && tile->seed == seed && tile->fuzz_amount == fuzz_amount
+            && tile->tile_size == tile_size && tile->bytes_per_pixel == bytes_per_pixel && tile->kind == kind) {
+            return tile;
+        }
+    }
+    return NULL;
+}
+
+//Returns the tile with a ref taken for the caller, or NULL if it could not be made.
+//A miss builds the tile with the lock released (up to a few hundred ms at the
+//largest size), so threads whose tiles are already cached aren't held up.
+static struct noise_tile* acquire_noise_tile(const uint32_t seed, const uint8_t fuzz_amount, const size_t tile_size, const size_t bytes_per_pixel, const noise_kind kind) {
+    pthread_mutex_lock(&noise_cache_lock);
+    struct noise_tile* found = find_noise_tile(seed, fuzz_amount, tile_size, bytes_per_pixel, kind);
+    if (found != NULL) {
+        found->refs++;
+        pthread_mutex_unlock(&noise_cache_lock);
+        return found;
+    }
+    pthread_mutex_unlock(&noise_cache_lock);
+
+    struct noise_tile* made = make_noise_tile(seed, fuzz_amount, tile_size, bytes_per_pixel, kind);
+    if (made == NULL) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&noise_cache_lock);
+    //another thread may have built the same tile in the meantime. Keep theirs.
+    found = find_noise_tile(seed, fuzz_amount, tile_size, bytes_per_pixel, kind);
+    if (found != NULL) {
+        release_noise_tile(made);
+    } else {
+        found = made;
+        release_noise_tile(noise_cache[noise_cache_next]);
+        noise_cache[noise_cache_next] = found;
+        noise_cache_next = (noise_cache_next + 1) % NOISE_CACHE_COUNT;
+    }
+    found->refs++;
+    pthread_mutex_unlock(&noise_cache_lock);
+    return found;
+}
+
+int fuzz_buffer_cached(const uint32_t seed,
+                       const uint8_t fuzz_amount,
+                       const size_t tile_size,
+                       const noise_kind kind,
+                       const size_t width,
+                       const size_t height,
+                       const size_t bytes_per_pixel,
+                       uint32_t* offset_state,
+                       const void* input_buffer,
+                       void* output_buffer
+                       ) {
+    const size_t side = (tile_size != 0) ? tile_size : NOISE_DEFAULT_TILE;
+    if (offset_state == NULL || side > NOISE_MAX_TILE || bytes_per_pixel == 0 || bytes_per_pixel > NOISE_MAX_BYTES_PER_PIXEL
+        || (kind != NOISE_UNIFORM && kind != NOISE_HIGH_PASS)) {
+        return -1;
+    }
+    if (width != 0 && height > SIZE_MAX / width / bytes_per_pixel) {
+        return -1;
+    }
+
+    struct noise_tile* tile = acquire_noise_tile(seed, fuzz_amount, side, bytes_per_pixel, kind);
+    if (tile == NULL) {
+        return -1;
+    }
+
+    //two steps of the caller's own state per frame instead of rand() per byte.
+    //Not rand(): it isn't thread safe on MacOS, and a shared sequence would make
+    //each stream's offsets depend on what every other thread drew.
+    if (*offset_state == 0) {
+        *offset_state = seed ^ 0x9E3779B9;
+        if (*offset_state == 0) { *offset_state = 0x9E3779B9; }
+    }
+    const size_t offset_x = random_step_r(offset_state) % side;
+    const size_t offset_y = random_step_r(offset_state) % side;
+    const size_t frame_row_bytes = width * bytes_per_pixel;
+    const unsigned char* in = input_buffer;
+    unsigned char* out = output_buffer;
+    for (size_t y = 0; y < height; y++) {
+        const size_t tile_row = (y + offset_y) % side;
+        const uint8_t* up = tile->up + tile_row * tile->row_stride + offset_x * bytes_per_pixel;
+        const uint8_t* down = tile->down + tile_row * tile->row_stride + offset_x * bytes_per_pixel;
+        const size_t row_start = y * frame_row_bytes;
+        for (size_t start = 0; start < frame_row_bytes; start += tile->row_bytes) {
+            size_t chunk = frame_row_bytes - start;
+            if (chunk > tile->row_bytes) { chunk = tile->row_bytes; }
+            bulk_kernels()->apply_up_down(in + row_start + start, up, down, out + row_start + start, chunk);
+        }
+    }
+
+    pthread_mutex_lock(&noise_cache_lock);
+    release_noise_tile(tile);
+    pthread_mutex_unlock(&noise_cache_lock);
+    return 0;
+}
+
+void noise_cache_clear() {
+    pthread_mutex_lock(&noise_cache_lock);
+    for (size_t i = 0; i < NOISE_CACHE_COUNT; i++) {
+        //tiles still in use by another thread are freed when it lets go.
+        release_noise_tile(noise_cache[i]);
+        noise_cache[i] = NULL;
+    }
+    noise_cache_next = 0;
+    pthread_mutex_unlock(&noise_cache_lock);
+}
 
 //-------------------------------------------------------------------
 //MARK: Working with Void*
@@ -232,18 +660,20 @@ void set_all_bits_high(void* array, const size_t n, const size_t type_size) {
     uint8_t* cast = ((unsigned char *) array);
     
     //Finer grain control for reference.
-    for (size_t item = 0; item < n; item ++) {
-        for (size_t byte = 0; byte < type_size; byte++) {
-            cast[byte + item*type_size] = 255;
-        }
-    }
+    //    for (size_t item = 0; item < n; item ++) {
+    //        for (size_t byte = 0; byte < type_size; byte++) {
+    //            cast[byte + item*type_size] = 255;
+    //        }
+    //    }
+    bulk_kernels()->fill_bytes(cast, 255, type_size * n);
 }
 
 void set_all_bits_low(void* array, const size_t n, const size_t type_size) {
     uint8_t* cast = ((unsigned char *) array);
-    for (size_t byte = 0; byte < type_size * n; byte++) {
-        cast[byte] = 0;
-    }
+    //    for (size_t byte = 0; byte < type_size * n; byte++) {
+    //        cast[byte] = 0;
+    //    }
+    bulk_kernels()->fill_bytes(cast, 0, type_size * n);
 }
 
 void set_all_bits_random(void* array, const size_t n, const size_t type_size) {
@@ -330,6 +760,40 @@ void random_scramble(const char* input, char* output, size_t* length) {
     //    }
 }
 
+//---- Bounded versions
+//snprintf style: write at most capacity bytes (NUL included), return the
+//length the full result needs (NUL not included). result can be NULL when
+//capacity is 0. No printing, no allocation.
+
+void print_message_n(const char* message, const size_t length) {
+    //Swift hands over a NULL base address for an empty string.
+    if (message == NULL) { message = ""; }
+    printf("I have a message for you... %.*s\n", (int)length, message);
+}
+
+size_t answer_to_life_n(char* result, const size_t capacity) {
+    int written = snprintf(result, capacity, "The answer to life, the universe and everything is %d", rand());
+    return (written < 0) ? 0 : written;
+}
+
+size_t build_concise_message_n(char* result, const size_t capacity) {
+    int written = snprintf(result, capacity, "%s", "abcdefghijklmnopqrstuvwxyz");
+    return (written < 0) ? 0 : written;
+}
+
+//input does not need to be NUL terminated, only its length is used (same as random_scramble).
+size_t random_scramble_n(const char* input, const size_t input_length, char* output, const size_t capacity) {
+    (void)input;
+    if (output != NULL && capacity > 0) {
+        size_t count = (input_length < capacity) ? input_length : capacity - 1;
+        for (size_t i = 0; i < count; i++) {
+            output[i] = random_letter();
+        }
+        output[count] = 0;
+    }
+    return input_length;
+}
+
 
 //-------------------------------------------------------------------
 //MARK: Utility Prints
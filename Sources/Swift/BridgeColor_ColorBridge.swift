@@ -55,6 +55,14 @@ extension BridgeColor {
         }
     }
     
+    //No print, and the header-only C function can be inlined into the caller.
+    public var asUInt32: UInt32 {
+        withUnsafeBytes(of: self) { (buffer) -> UInt32 in
+            //C:-- static inline uint32_t int_from_copaque_color_ptr_inline(const COpaqueColor* color)
+            int_from_copaque_color_ptr_inline(OpaquePointer(buffer.baseAddress))
+        }
+    }
+    
     
 }
 
@@ -76,8 +84,8 @@ public class ColorBridge {
     
     
     public func setColor(red:UInt8, green:UInt8, blue:UInt8, alpha:UInt8) {
-        //C:-- void set_color_values(COpaqueColor* c, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
-        set_color_values(_ptr, red, green, blue, alpha)
+        //C:-- static inline void set_color_values_inline(COpaqueColor* c, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
+        set_color_values_inline(_ptr, red, green, blue, alpha)
         
     }
     
@@ -87,20 +95,27 @@ public class ColorBridge {
         delete_pointer_for_ccolor(_ptr)
     }
     
-    //C:-- uint8_t ccolor_get_red(COpaqueColor* c) { return c->red; }
+    //C:-- static inline uint8_t ccolor_get_red_inline(const COpaqueColor* c)
+    //The _inline versions (random_provider_inline.h) are static inline so
+    //Swift can inline them instead of making a call per property read.
     //In real implementation would also write setters.
     public var red: UInt8 {
-        get { return ccolor_get_red(_ptr) }
+        get { return ccolor_get_red_inline(_ptr) }
     }
     
     public var green: UInt8 {
-        get { return ccolor_get_green(_ptr) }
+        get { return ccolor_get_green_inline(_ptr) }
     }
     public var blue: UInt8 {
-        get { return ccolor_get_blue(_ptr) }
+        get { return ccolor_get_blue_inline(_ptr) }
     }
     public var alpha: UInt8 {
-        get { return ccolor_get_alpha(_ptr) }
+        get { return ccolor_get_alpha_inline(_ptr) }
+    }
+    
+    public var asUInt32: UInt32 {
+        //C:-- static inline uint32_t int_from_copaque_color_ptr_inline(const COpaqueColor* color)
+        int_from_copaque_color_ptr_inline(_ptr)
     }
     
 }
@@ -200,7 +200,61 @@ public struct RandomProvider {
         
         return outputBuffer
     }
-    
+
+    public enum NoiseKind:UInt32 {
+        case uniform = 0, highPass
+    }
+
+    //For streams of frames. The noise texture for (seed, fuzzAmount, tileSize, bytesPerPixel, kind)
+    //is made once on the C side and reused, each call only moves it to a new random (x, y) offset.
+    //The offsets come from offsetState, which the caller keeps per stream (start it at 0 to derive
+    //it from seed). Same seed and starting state, same frames. Safe to call from several threads
+    //as long as each one has its own offsetState.
+    //tileSize is pixels per side, 0 means the C default (64), max 1024.
+    public func fuzzedFrame(_ frame:[UInt8], width:Int, height:Int, bytesPerPixel:Int, fuzzAmount:UInt8, seed:UInt32, offsetState:inout UInt32, tileSize:Int = 64, kind:NoiseKind = .uniform) -> [UInt8] {
+        precondition(tileSize >= 0, "tileSize can't be negative")
+        precondition(width >= 0 && height >= 0 && bytesPerPixel > 0, "width and height can't be negative, bytesPerPixel must be at least 1")
+        precondition(frame.count == width * height * bytesPerPixel, "frame is not width * height * bytesPerPixel bytes")
+        return Array<UInt8>(unsafeUninitializedCapacity: frame.count) { buffer, initializedCount in
+            frame.withUnsafeBytes { framePointer in
+                //C:-- int fuzz_buffer_cached(const uint32_t seed, const uint8_t fuzz_amount, const size_t tile_size, const noise_kind kind, const size_t width, const size_t height, const size_t bytes_per_pixel, uint32_t* offset_state, const void* input_buffer, void* output_buffer);
+                let result = fuzz_buffer_cached(seed, fuzzAmount, tileSize, noise_kind(rawValue: kind.rawValue), width, height, bytesPerPixel, &offsetState, framePointer.baseAddress, buffer.baseAddress)
+                precondition(result == 0, "fuzz_buffer_cached failed: tileSize over 1024, bytesPerPixel over 16, or the noise tile could not be allocated")
+            }
+            initializedCount = frame.count
+        }
+    }
+
+    public func clearNoiseCache() {
+        //C:-- void noise_cache_clear();
+        noise_cache_clear()
+    }
+
+    //MARK: Bulk Kernel Variants
+
+    //Mirrors the C enum so callers that never import the C target can still pick one.
+    //C enums without NS_ENUM come in as a struct with a rawValue, hence the round trip.
+    public enum BulkKernel:UInt32 {
+        case scalar = 0, sse2, avx2, avx512
+    }
+
+    public var detectedBulkKernel:BulkKernel {
+        //C:-- bulk_kernel_level bulk_kernel_detected();
+        BulkKernel(rawValue: bulk_kernel_detected().rawValue) ?? .scalar
+    }
+
+    public var activeBulkKernel:BulkKernel {
+        //C:-- bulk_kernel_level bulk_kernel_active();
+        BulkKernel(rawValue: bulk_kernel_active().rawValue) ?? .scalar
+    }
+
+    //For benchmarking each path. Returns false if this CPU can't run it.
+    @discardableResult
+    public func overrideBulkKernel(_ kernel:BulkKernel) -> Bool {
+        //C:-- int bulk_kernel_override(const bulk_kernel_level level);
+        bulk_kernel_override(bulk_kernel_level(rawValue: kernel.rawValue)) == 0
+    }
+
     //MARK: Void* Array Handling
     
     //All the C functions below take void* reference.
@@ -260,6 +314,19 @@ public struct RandomProvider {
     }
     
     
+    //Same colors as above but from a caller seed, without rand() or the acknowledge print.
+    //The generator step and packer are static inline C, so this loop can be inlined whole.
+    public func makeRandomUInt32Buffer(count:Int, seed:UInt32) -> [UInt32] {
+        var state = (seed != 0) ? seed : 0x9E3779B9 //xorshift state can't be 0
+        return Array<UInt32>(unsafeUninitializedCapacity: count) { buffer, initializedCount in
+            for i in 0..<count {
+                //C:-- static inline uint32_t random_color_full_alpha_r_inline(uint32_t* state)
+                buffer[i] = random_color_full_alpha_r_inline(&state)
+            }
+            initializedCount = count
+        }
+    }
+    
     public func printUInt32BufferAsColor(_ buffer:[UInt32]) {
         for item in buffer {
             //print(String(format: "0x%08x", item))
@@ -505,6 +572,72 @@ public struct RandomProvider {
         }
     }
     
+    //MARK: Strings, bounded (no allocation, no print)
+    
+    //The *_n C functions are snprintf style, they write straight into the String's
+    //own storage and say how long the full result is. No [UInt8] scratch, no print,
+    //one C call unless the first guess at capacity was too small.
+    private func stringFromBoundedC(capacity:Int, _ write:(UnsafeMutablePointer<CChar>?, Int) -> Int) -> String {
+        var needed = 0
+        var fit = false
+        let result = String(unsafeUninitializedCapacity: capacity) { buffer in
+            buffer.withMemoryRebound(to: CChar.self) { charBuffer in
+                needed = write(charBuffer.baseAddress, charBuffer.count)
+                fit = needed < charBuffer.count
+            }
+            return fit ? needed : 0
+        }
+        if fit { return result }
+        return String(unsafeUninitializedCapacity: needed + 1) { buffer in
+            buffer.withMemoryRebound(to: CChar.self) { charBuffer in
+                write(charBuffer.baseAddress, charBuffer.count)
+            }
+        }
+    }
+    
+    public func getAnswerBounded() -> String {
+        //64 always fits (51 char prefix + at most 10 digits + NUL), which matters
+        //because a second call would roll a different number.
+        stringFromBoundedC(capacity: 64) { buffer, capacity in
+            //C:-- size_t answer_to_life_n(char* result, const size_t capacity);
+            answer_to_life_n(buffer, capacity)
+        }
+    }
+    
+    public func getStringBounded() -> String {
+        stringFromBoundedC(capacity: 32) { buffer, capacity in
+            //C:-- size_t build_concise_message_n(char* result, const size_t capacity);
+            build_concise_message_n(buffer, capacity)
+        }
+    }
+    
+    public func scrambleMessageBounded(message:String) -> String {
+        //withUTF8 is mutating (it may have to make the string contiguous), hence the var.
+        //For a native Swift string it is already contiguous and nothing is copied.
+        var message = message
+        return message.withUTF8 { utf8 in
+            String(unsafeUninitializedCapacity: utf8.count + 1) { buffer in
+                buffer.withMemoryRebound(to: CChar.self) { charBuffer in
+                    utf8.withMemoryRebound(to: CChar.self) { input in
+                        //C:-- size_t random_scramble_n(const char* input, const size_t input_length, char* output, const size_t capacity);
+                        random_scramble_n(input.baseAddress, input.count, charBuffer.baseAddress, charBuffer.count)
+                    }
+                }
+            }
+        }
+    }
+    
+    //Passes the String's own UTF8 bytes and a length instead of a temporary C string.
+    public func cPrintMessageBounded(message:String) {
+        var message = message
+        message.withUTF8 { utf8 in
+            utf8.withMemoryRebound(to: CChar.self) { input in
+                //C:-- void print_message_n(const char* message, const size_t length);
+                print_message_n(input.baseAddress, input.count)
+            }
+        }
+    }
+    
 }
 
 